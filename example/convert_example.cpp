@@ -22,6 +22,14 @@ int main() {
     
     // for now, std::vector<std::vector<int>> does not yet work
     
+    // input arriving in pieces, tokens may be split between them
+    std::vector<int> vec;
+    fsc::sto_parser<std::vector<int>> parser(vec);
+    parser.push("[1, 2");
+    parser.push("5, 7]");
+    parser.finish();
+    std::cout << vec << std::endl; // [1, 25, 7]
+    
     // exceptions
     fsc::sto<int>("24.12"); // will throw std::runtime_error;
     fsc::sto<int>("24foo"); // will throw std::runtime_error;
@@ -27,5 +27,10 @@ int main() {
     m["b"] = 1;
     std::cout << m << std::endl;  // "{a: 1, b: 1, c: 1}"
 
+    // bounded printing: at most 4 elements, 2 nesting levels, 100 bytes
+    std::vector<int> large(1000000, 7);
+    std::cout << fsc::print_limits{4, 2, 100} << large << std::endl;
+    // "[7, 7, ... (999996 more), 7, 7]"
+
     return 0;
 }
@@ -15,47 +15,200 @@
 #include <iostream>
 
 #include <assert.h>
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstdint>
+#include <deque>
+#include <exception>
 #include <iterator>
 #include <limits>
 #include <map>
+#include <mutex>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+// forward declaration, so that nested containers find each other
+template <typename T>
+inline std::ostream &operator<<(std::ostream &os, std::vector<T> const &arg);
+template <typename T, size_t N>
+inline std::ostream &operator<<(std::ostream &os, std::array<T, N> const &arg);
+template <typename K, typename V>
+inline std::ostream &operator<<(std::ostream &os, std::map<K, V> const &arg);
+
 /// \brief support functions for the std containers
 ///
 /// We define functions to help with IO of std containers
 namespace fsc {
-//=================== to_string ===================
+//=================== print limits ===================
 /// \cond IMPLEMENTATION_DETAIL_DOC
 namespace detail {
+    struct print_slots {
+        int const max_elements = std::ios_base::xalloc();
+        int const max_depth = std::ios_base::xalloc();
+        int const max_bytes = std::ios_base::xalloc();
+        int const depth = std::ios_base::xalloc();
+        int const buffer = std::ios_base::xalloc();
+    };
+
+    inline print_slots const &print_slot() {
+        static print_slots const slots;
+        return slots;
+    }
+
+    inline size_t print_limit(std::ostream &os, int slot) {
+        return static_cast<size_t>(os.iword(slot));
+    }
+
+    // true if os is a print buffer that already exceeds max_bytes
+    inline bool print_exhausted(std::ostream &os) {
+        auto const max_bytes = print_limit(os, print_slot().max_bytes);
+        return max_bytes != 0 and static_cast<size_t>(os.tellp()) > max_bytes;
+    }
+
+    // head and tail elements of c according to max_elements
+    template <typename C, typename F>
+    void print_elements(std::ostream &os, C const &c, F print_elem) {
+        auto const n = c.size();
+        auto const max = print_limit(os, print_slot().max_elements);
+        size_t head = n;
+        size_t tail = 0;
+        if(max != 0 and n > max) {
+            head = (max + 1) / 2;
+            tail = max / 2;
+        }
+        auto it = c.begin();
+        for(size_t i = 0; i < head; ++i, ++it) {
+            if(print_exhausted(os)) return;
+            if(i != 0) os << ", ";
+            print_elem(os, *it);
+        }
+        if(head == n) return;
+        os << ", ... (" << n - head - tail << " more)";
+        for(it = std::prev(c.end(), static_cast<std::ptrdiff_t>(tail));
+            it != c.end(); ++it) {
+            if(print_exhausted(os)) return;
+            os << ", ";
+            print_elem(os, *it);
+        }
+    }
+
+    template <typename C, typename F>
+    void print_container(std::ostream &os, C const &c, char const *open,
+                         char const *close, F print_elem) {
+        auto const &slot = print_slot();
+        if(os.pword(slot.buffer) == nullptr) {
+            // outermost container: format into a clean buffer, so that the
+            // flags of os apply to the whole container and not to the
+            // elements (as with to_string), and cut it at max_bytes
+            std::stringstream out;
+            out.iword(slot.max_elements) = os.iword(slot.max_elements);
+            out.iword(slot.max_depth) = os.iword(slot.max_depth);
+            out.iword(slot.max_bytes) = os.iword(slot.max_bytes);
+            out.pword(slot.buffer) = &out;
+            print_container(out, c, open, close, print_elem);
+
+            auto str = out.str();
+            auto const max_bytes = print_limit(os, slot.max_bytes);
+            if(max_bytes != 0 and str.size() > max_bytes) {
+                // the marker is part of the budget
+                std::string const marker = "...";
+                auto const keep =
+                    max_bytes - std::min(max_bytes, marker.size());
+                str.erase(keep);
+                str.append(marker, 0, max_bytes - keep);
+            }
+            os << str;
+            return;
+        }
+
+        auto const max_depth = print_limit(os, slot.max_depth);
+        if(max_depth != 0 and print_limit(os, slot.depth) >= max_depth) {
+            os << open << "..." << close;
+            return;
+        }
+
+        // no reference into iword is kept, since it gets invalidated
+        struct depth_guard {
+            std::ostream &stream;
+            int index;
+            ~depth_guard() { --stream.iword(index); }
+        } guard{os, slot.depth};
+        ++os.iword(slot.depth);
+
+        os << open;
+        print_elements(os, c, print_elem);
+        os << close;
+    }
+
+    template <typename T>
+    void print_array(std::ostream &os, T const &arr) {
+        print_container(os, arr, "[", "]",
+                        [](std::ostream &out, auto const &a) { out << a; });
+    }
+
+    template <typename T>
+    void print_map(std::ostream &os, T const &m) {
+        print_container(os, m, "{", "}", [](std::ostream &out, auto const &kv) {
+            out << kv.first << ": " << kv.second;
+        });
+    }
+
     template <typename T>
     std::string array_to_string_impl(T const &arr) {
         std::stringstream ss;
-        ss << "[";
-        for(size_t i = 0; i < arr.size(); ++i) {
-            if(i != 0) ss << ", ";
-            ss << arr[i];
-        }
-        ss << "]";
+        print_array(ss, arr);
         return ss.str();
     }
 
     template <typename T>
     std::string map_to_string_impl(T const &m) {
         std::stringstream ss;
-        ss << "{";
-        for(auto it = m.begin(); it != m.end(); ++it) {
-            if(it != m.begin()) ss << ", ";
-            ss << it->first << ": " << it->second;
-        }
-        ss << "}";
+        print_map(ss, m);
         return ss.str();
     }
 }  // end namespace detail
 /// \endcond
 
+/// \brief Stream manipulator that bounds the printing of containers
+///
+/// The limits stay set on the stream until they are replaced, a value of
+/// 0 means unlimited. They apply to `operator<<` for `std::vector`,
+/// `std::array` and `std::map`, the work done is bounded by the limits and
+/// not by the size of the container.
+///
+/// Example:
+/// ~~~{.cpp}
+/// std::vector<int> vec{1, 2, 3, 4, 5, 6, 7};
+/// std::cout << fsc::print_limits{4} << vec;   // "[1, 2, ... (3 more), 6, 7]"
+/// std::cout << fsc::print_limits{};           // unlimited again
+/// ~~~
+struct print_limits {
+    /// number of elements shown, split between head and tail
+    size_t max_elements = 0;
+    /// nesting levels shown, deeper containers are printed as `[...]`
+    size_t max_depth = 0;
+    /// bytes written, longer output is cut and ends in `...` (the marker
+    /// counts towards max_bytes)
+    size_t max_bytes = 0;
+
+    /// \brief Sets the limits on the stream
+    /// \param os: the stream that will print the containers
+    /// \param lim: the new limits
+    friend std::ostream &operator<<(std::ostream &os, print_limits const &lim) {
+        auto const &slot = detail::print_slot();
+        os.iword(slot.max_elements) = static_cast<long>(lim.max_elements);
+        os.iword(slot.max_depth) = static_cast<long>(lim.max_depth);
+        os.iword(slot.max_bytes) = static_cast<long>(lim.max_bytes);
+        return os;
+    }
+};
+
+//=================== to_string ===================
+
 /// \brief Generic version that can be specialized or overloaded
 /// (since partial function specialization is not possible).
 /// Just forwards to std::to_string
@@ -166,6 +319,122 @@ inline std::vector<std::string> split(std::string /*copy*/ text,
     }
 }
 
+/// \brief Thread safe table that maps strings to compact integer ids
+///
+/// Every distinct string is stored once, equal strings get the same id. The
+/// table is split into independently locked shards, so parallel workers can
+/// share one table. Ids and the references returned by str() stay valid for
+/// the lifetime of the table.
+///
+/// Example:
+/// ~~~{.cpp}
+/// fsc::intern_table table;
+/// auto a = table.intern("host1");
+/// auto b = table.intern("host1");   // a == b
+/// auto str = table.str(a);          // str == "host1"
+/// ~~~
+class intern_table {
+public:
+    /// \brief The type of the ids handed out
+    using id_type = uint32_t;
+
+    /// \brief Returns the id of text and adds it if it is not known yet
+    /// \exception std::length_error: If the ids are exhausted
+    id_type intern(std::string const &text) {
+        // the string is hashed only once, the shard maps that hash to the
+        // candidate ids, which are then compared directly
+        auto const hash = std::hash<std::string>()(text);
+        auto const shard_idx = hash % n_shards;
+        auto &sh = shards_[shard_idx];
+        std::lock_guard<std::mutex> lock(sh.mutex);
+        auto range = sh.ids.equal_range(hash);
+        for(auto it = range.first; it != range.second; ++it) {
+            if(sh.strings[it->second / n_shards] == text) return it->second;
+        }
+
+        auto const id = sh.strings.size() * n_shards + shard_idx;
+        if(id > std::numeric_limits<id_type>::max()) {
+            throw std::length_error("fsc::intern_table: ids exhausted");
+        }
+        sh.strings.push_back(text);
+        sh.ids.emplace(hash, static_cast<id_type>(id));
+        return static_cast<id_type>(id);
+    }
+
+    /// \brief Returns the string that belongs to id
+    /// \exception std::out_of_range: If the id was not handed out by this
+    /// table
+    std::string const &str(id_type id) const {
+        auto const &sh = shards_[id % n_shards];
+        std::lock_guard<std::mutex> lock(sh.mutex);
+        return sh.strings.at(id / n_shards);
+    }
+
+    /// \brief The number of distinct strings in the table
+    size_t size() const {
+        size_t res = 0;
+        for(auto const &sh : shards_) {
+            std::lock_guard<std::mutex> lock(sh.mutex);
+            res += sh.strings.size();
+        }
+        return res;
+    }
+
+private:
+    static constexpr size_t n_shards = 16;
+
+    struct shard {
+        mutable std::mutex mutex;
+        std::unordered_multimap<size_t, id_type> ids;  // by string hash
+        std::deque<std::string> strings;  // never moves its elements
+    };
+
+    std::array<shard, n_shards> shards_;
+};
+
+/// \brief Splits a string on a delimiter and interns the parts
+/// \param text: The input string
+/// \param table: The table that receives the parts, can be shared between
+/// threads
+/// \param delimiter: the delimiter string (not char)
+/// \returns the ids of the parts in table
+///
+/// Splits exactly like split(text, delimiter), but repeated parts only cost
+/// one id each instead of a `std::string`.
+inline std::vector<intern_table::id_type> split(
+    std::string const &text, intern_table &table,
+    std::string const &delimiter = " ") {
+    std::vector<intern_table::id_type> res;
+    std::string token;  // reused, so known tokens don't allocate
+
+    if(delimiter == " ") {
+        // whitespace separated, like the istream_iterator version
+        auto is_space = [](char c) {
+            return std::isspace(static_cast<unsigned char>(c)) != 0;
+        };
+        auto it = text.begin();
+        while(true) {
+            it = std::find_if_not(it, text.end(), is_space);
+            if(it == text.end()) break;
+            auto end = std::find_if(it, text.end(), is_space);
+            token.assign(it, end);
+            res.push_back(table.intern(token));
+            it = end;
+        }
+    } else {
+        size_t start = 0;
+        size_t pos = 0;
+        while((pos = text.find(delimiter, start)) != std::string::npos) {
+            token.assign(text, start, pos - start);
+            res.push_back(table.intern(token));
+            start = pos + delimiter.length();
+        }
+        token.assign(text, start, std::string::npos);
+        res.push_back(table.intern(token));
+    }
+    return res;
+}
+
 /// \brief Strips whitespace from the begin and end of the string
 /// \param text: The input string
 /// \returns The input with removed whitespace
@@ -298,6 +567,122 @@ T sto(std::string const &text) {
     return detail::sto_impl<T>::sto(text);
 }
 
+/// \brief Incremental version of sto<T> for input that arrives in chunks
+///
+/// Only implemented for `std::vector<T>`, see the specialization.
+template <typename T>
+class sto_parser {
+    static_assert(sizeof(T) == 0, "fsc::sto_parser<T>: type not supported");
+};
+
+/// \brief Push-style parser for `std::vector<T>` literals
+///
+/// The chunks can split tokens anywhere. Completed elements are appended
+/// to the output vector as soon as their terminating comma arrives, so
+/// only the element currently being read is buffered. The result is the
+/// same as `sto<std::vector<T>>` on the concatenated input. If finish()
+/// throws, the elements appended by this parser are removed again, so the
+/// output is left as it was before parsing.
+///
+/// Example:
+/// ~~~{.cpp}
+/// std::vector<int> vec;
+/// fsc::sto_parser<std::vector<int>> parser(vec);
+/// parser.push("[1, 2");
+/// parser.push("3, 4]");
+/// parser.finish();   // vec == {1, 23, 4}
+/// ~~~
+template <typename T>
+class sto_parser<std::vector<T>> {
+public:
+    /// \param out: the vector the parsed elements get appended to
+    explicit sto_parser(std::vector<T> &out)
+        : out_(out), out_size_(out.size()) {}
+
+    /// \brief Feeds the next chunk of input
+    /// \exception std::runtime_error: If the input does not start with `[`
+    /// or the parser was already finished
+    void push(char const *data, size_t len) {
+        if(state_ == state::done) {
+            throw std::runtime_error(
+                "fsc::sto_parser<std::vector<T>>: push after finish");
+        }
+        char const *pos = data;
+        char const *end = data + len;
+        if(state_ == state::open) {
+            while(pos != end and *pos == ' ') ++pos;
+            if(pos == end) return;
+            if(*pos != '[') {
+                throw std::runtime_error(
+                    "fsc::sto_parser<std::vector<T>>: input does not start "
+                    "with [");
+            }
+            state_ = state::body;
+            ++pos;
+        }
+        while(true) {
+            char const *comma = std::find(pos, end, ',');
+            buffer_.append(pos, comma);
+            if(comma == end) break;
+            emit();
+            pos = comma + 1;
+        }
+    }
+    /// \brief Overloaded version for std::string
+    void push(std::string const &chunk) { push(chunk.data(), chunk.size()); }
+
+    /// \brief Signals the end of the input and converts the last element
+    /// \exception std::runtime_error: If the input is not enclosed in `[]`
+    /// \exception Any exception sto<T> threw for an element
+    ///
+    /// Element errors are held back until here, so that the reported error
+    /// is the same one `sto<std::vector<T>>` would throw.
+    void finish() {
+        if(state_ == state::done) return;
+        auto end = buffer_.size();
+        while(end > 0 and buffer_[end - 1] == ' ') --end;
+        if(state_ == state::open or end == 0 or buffer_[end - 1] != ']') {
+            state_ = state::done;
+            out_.resize(out_size_);
+            throw std::runtime_error(
+                "fsc::sto_parser<std::vector<T>>: could not convert input "
+                "fully to std::vector<T>");
+        }
+        buffer_.erase(end - 1);
+        emit();
+        state_ = state::done;
+        std::string().swap(buffer_);
+        if(error_) {
+            out_.resize(out_size_);
+            std::rethrow_exception(error_);
+        }
+    }
+
+    /// \brief True once finish() was called
+    bool done() const { return state_ == state::done; }
+
+private:
+    void emit() {
+        if(!error_) {
+            try {
+                using fsc::sto;  // to allow external overloads
+                out_.push_back(sto<T>(buffer_));
+            } catch(...) {
+                error_ = std::current_exception();
+            }
+        }
+        buffer_.clear();
+    }
+
+    enum class state { open, body, done };
+
+    std::vector<T> &out_;
+    size_t out_size_;  // to roll back on errors
+    std::string buffer_;
+    std::exception_ptr error_;
+    state state_ = state::open;
+};
+
 /// \brief Tries to get an element from a map and falls back to a default if
 /// it does not exist.
 /// \returns Eighter the value to the key if it exists, and the default
@@ -331,30 +716,33 @@ Value const &get(
 /// \param os: the destination stream
 /// \param arg: the vector to print
 ///
-/// Just uses std::to_string internally.
+/// Formats like fsc::to_string and respects fsc::print_limits. Stream
+/// flags like `std::setw` apply to the whole container, not the elements.
 template <typename T>
 inline std::ostream &operator<<(std::ostream &os, std::vector<T> const &arg) {
-    os << fsc::to_string(arg);
+    fsc::detail::print_array(os, arg);
     return os;
 }
 /// \brief prints a `std::array<T, N>`
 /// \param os: the destination stream
 /// \param arg: the array to print
 ///
-/// Just uses std::to_string internally.
+/// Formats like fsc::to_string and respects fsc::print_limits. Stream
+/// flags like `std::setw` apply to the whole container, not the elements.
 template <typename T, size_t N>
 inline std::ostream &operator<<(std::ostream &os, std::array<T, N> const &arg) {
-    os << fsc::to_string(arg);
+    fsc::detail::print_array(os, arg);
     return os;
 }
 /// \brief prints a `std::map<K, V>`
 /// \param os: the destination stream
 /// \param arg: the map to print
 ///
-/// Just uses std::to_string internally.
+/// Formats like fsc::to_string and respects fsc::print_limits. Stream
+/// flags like `std::setw` apply to the whole container, not the elements.
 template <typename K, typename V>
 inline std::ostream &operator<<(std::ostream &os, std::map<K, V> const &arg) {
-    os << fsc::to_string(arg);
+    fsc::detail::print_map(os, arg);
     return os;
 }
 
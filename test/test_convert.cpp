@@ -11,6 +11,7 @@
 
 #include <catch.hpp>
 #include <fsc/stdSupport.hpp>
+#include <thread>
 
 TEST_CASE("testing sto<T>", "[fsc, sto<T>]") { 
     
@@ -61,3 +62,138 @@ TEST_CASE("testing sto<T>", "[fsc, sto<T>]") {
     
     
 }
+
+TEST_CASE("testing sto_parser<T>", "[fsc, sto_parser<T>]") {
+    //------------------- chunked vector -------------------
+    std::string text1 = "  [12, 345, 6, 78]  ";
+    auto cmp1 = fsc::sto<std::vector<int>>(text1);
+
+    for(size_t chunk = 1; chunk <= text1.size(); ++chunk) {
+        std::vector<int> vec1;
+        fsc::sto_parser<std::vector<int>> parser(vec1);
+        for(size_t i = 0; i < text1.size(); i += chunk) {
+            parser.push(text1.substr(i, chunk));
+        }
+        parser.finish();
+        CHECK(parser.done());
+        CHECK(vec1 == cmp1);
+    }
+
+    //------------------- elements arrive early -------------------
+    std::vector<int> vec2;
+    fsc::sto_parser<std::vector<int>> parser2(vec2);
+    parser2.push("[1, 2");
+    CHECK(vec2 == std::vector<int>{1});
+    parser2.push("3, 4]");
+    CHECK(vec2 == (std::vector<int>{1, 23}));
+    parser2.finish();
+    CHECK(vec2 == (std::vector<int>{1, 23, 4}));
+
+    //------------------- nested -------------------
+    std::string text3 = "[[1], [2], [3]]";
+    std::vector<std::vector<int>> vec3;
+    fsc::sto_parser<std::vector<std::vector<int>>> parser3(vec3);
+    parser3.push(text3.substr(0, 7));
+    parser3.push(text3.substr(7));
+    parser3.finish();
+    CHECK(vec3 == fsc::sto<std::vector<std::vector<int>>>(text3));
+
+    //------------------- errors -------------------
+    std::vector<int> vec4;
+    fsc::sto_parser<std::vector<int>> parser4(vec4);
+    CHECK_THROWS_AS(parser4.push(" 1, 2]"), std::runtime_error);
+
+    std::vector<int> vec5;
+    fsc::sto_parser<std::vector<int>> parser5(vec5);
+    parser5.push("[1, 2");
+    CHECK_THROWS_AS(parser5.finish(), std::runtime_error);
+
+    std::vector<uint8_t> vec6;
+    fsc::sto_parser<std::vector<uint8_t>> parser6(vec6);
+    parser6.push("[1, 300, 2]");
+    CHECK_THROWS_AS(parser6.finish(), std::out_of_range);
+    CHECK_THROWS_AS(fsc::sto<std::vector<uint8_t>>("[1, 300, 2]"),
+                    std::out_of_range);
+
+    // on errors the output is rolled back to what it held before
+    std::vector<int> vec7{9};
+    fsc::sto_parser<std::vector<int>> parser7(vec7);
+    parser7.push("[1, 2, x");
+    parser7.push(", 4]");
+    CHECK_THROWS_AS(parser7.finish(), std::invalid_argument);
+    CHECK(vec7 == std::vector<int>{9});
+
+    std::vector<int> vec8;
+    fsc::sto_parser<std::vector<int>> parser8(vec8);
+    parser8.push("[1, 2, 3");
+    CHECK_THROWS_AS(parser8.finish(), std::runtime_error);
+    CHECK(vec8.empty());
+}
+
+TEST_CASE("testing split with intern_table", "[fsc, split, intern_table]") {
+    fsc::intern_table table;
+
+    //------------------- whitespace -------------------
+    std::string text1 = "  info host1 get\tinfo  host2 get\n";
+    auto ids1 = fsc::split(text1, table);
+    auto cmp1 = fsc::split(text1);
+
+    REQUIRE(ids1.size() == cmp1.size());
+    for(size_t i = 0; i < ids1.size(); ++i) {
+        CHECK(table.str(ids1[i]) == cmp1[i]);
+    }
+    CHECK(ids1[0] == ids1[3]);
+    CHECK(ids1[2] == ids1[5]);
+    CHECK(table.size() == 4);
+
+    //------------------- delimiter -------------------
+    std::string text2 = "infofoobarhost1foobarfoobarinfo";
+    auto ids2 = fsc::split(text2, table, "foobar");
+    auto cmp2 = fsc::split(text2, "foobar");
+
+    REQUIRE(ids2.size() == cmp2.size());
+    for(size_t i = 0; i < ids2.size(); ++i) {
+        CHECK(table.str(ids2[i]) == cmp2[i]);
+    }
+    CHECK(ids2[0] == ids1[0]);
+    CHECK(table.size() == 5);  // "" is new
+
+    CHECK_THROWS_AS(table.str(1000), std::out_of_range);
+}
+
+TEST_CASE("testing shared intern_table", "[fsc, intern_table]") {
+    fsc::intern_table table;
+    size_t const n_threads = 8;
+    size_t const n_tokens = 1000;
+
+    // thread t interns the tokens t*100 ... t*100 + n_tokens - 1 a few times,
+    // so neighbouring threads overlap in 900 tokens
+    std::vector<std::vector<fsc::intern_table::id_type>> ids(n_threads);
+    std::vector<std::thread> workers;
+    for(size_t t = 0; t < n_threads; ++t) {
+        workers.emplace_back([&table, &ids, t, n_tokens]() {
+            for(size_t round = 0; round < 3; ++round) {
+                ids[t].clear();
+                for(size_t i = 0; i < n_tokens; ++i) {
+                    auto token = "token" + std::to_string(t * 100 + i);
+                    ids[t].push_back(table.intern(token));
+                }
+            }
+        });
+    }
+    for(auto &w : workers) w.join();
+
+    CHECK(table.size() == (n_threads - 1) * 100 + n_tokens);
+
+    std::map<std::string, fsc::intern_table::id_type> seen;
+    for(size_t t = 0; t < n_threads; ++t) {
+        for(size_t i = 0; i < n_tokens; ++i) {
+            auto token = "token" + std::to_string(t * 100 + i);
+            auto id = ids[t][i];
+            CHECK(table.str(id) == token);
+            auto it = seen.emplace(token, id).first;
+            CHECK(it->second == id);
+        }
+    }
+    CHECK(seen.size() == table.size());
+}
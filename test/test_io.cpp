@@ -11,6 +11,7 @@
 
 #include <array>
 #include <catch.hpp>
+#include <iomanip>
 #include <fsc/stdSupport.hpp>
 
 TEST_CASE("testing to_string", "[std, to_string]") {
@@ -47,4 +48,75 @@ TEST_CASE("testing to_string", "[std, to_string]") {
     ss << vec << arr << m;
 
     CHECK(ss.str() == cmp1 + cmp2 + cmp3);
+
+    //------------------- stream flags -------------------
+    // they apply to the whole container, the elements print like to_string
+    std::vector<int> vec2{10, 11, 12};
+    ss.str("");
+    ss << "[" << std::setw(14) << vec2 << "]";
+    CHECK(ss.str() == "[  [10, 11, 12]]");
+
+    ss.str("");
+    ss << std::hex << vec2 << std::dec;
+    CHECK(ss.str() == fsc::to_string(vec2));
+}
+
+TEST_CASE("testing print_limits", "[std, print_limits]") {
+    std::vector<int> vec{1, 2, 3, 4, 5, 6, 7};
+    std::stringstream ss;
+
+    //------------------- max_elements -------------------
+    ss << fsc::print_limits{4} << vec;
+    CHECK(ss.str() == "[1, 2, ... (3 more), 6, 7]");
+
+    ss.str("");
+    ss << fsc::print_limits{3} << vec;
+    CHECK(ss.str() == "[1, 2, ... (4 more), 7]");
+
+    ss.str("");
+    std::map<int, int> m{{1, 1}, {2, 2}, {3, 3}, {4, 4}};
+    ss << fsc::print_limits{2} << m;
+    CHECK(ss.str() == "{1: 1, ... (2 more), 4: 4}");
+
+    ss.str("");
+    std::array<int, 3> arr{1, 2, 3};
+    ss << fsc::print_limits{3} << arr;
+    CHECK(ss.str() == "[1, 2, 3]");
+
+    //------------------- max_depth -------------------
+    std::vector<std::vector<int>> nested{{1, 2}, {3}};
+    ss.str("");
+    ss << fsc::print_limits{0, 1} << nested;
+    CHECK(ss.str() == "[[...], [...]]");
+
+    ss.str("");
+    ss << fsc::print_limits{0, 2} << nested;
+    CHECK(ss.str() == "[[1, 2], [3]]");
+
+    //------------------- max_bytes -------------------
+    std::vector<int> large(1000000, 42);
+    ss.str("");
+    ss << fsc::print_limits{0, 0, 10} << large;
+    CHECK(ss.str() == "[42, 42...");  // the marker counts towards the limit
+
+    ss.str("");
+    ss << fsc::print_limits{0, 0, 9} << vec;
+    CHECK(ss.str() == "[1, 2,...");
+
+    ss.str("");
+    ss << fsc::print_limits{0, 0, 100} << vec;
+    CHECK(ss.str() == "[1, 2, 3, 4, 5, 6, 7]");
+
+    ss.str("");
+    ss << fsc::print_limits{0, 0, 2} << vec;
+    CHECK(ss.str() == "..");
+
+    ss.str("");
+    ss << "[" << std::setw(14) << fsc::print_limits{0, 0, 8} << large << "]";
+    CHECK(ss.str() == "[      [42, ...]");
+
+    //------------------- reset -------------------
+    ss.str("");
+    ss << fsc::print_limits{} << vec;
+    CHECK(ss.str() == fsc::to_string(vec));
 }
@@ -0,0 +1,121 @@
+#define MIB_TAGS main, split, intern, intern_par
+#define MIB_TEST main, split, intern, intern_par
+
+#include <fsc/profiler.hpp>
+#include <fsc/stdSupport.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+// rough heap + object size of the results
+
+size_t bytes(std::vector<std::string> const &v) {
+    size_t res = v.capacity() * sizeof(std::string);
+    std::string const empty;
+    for(auto const &s : v) {
+        if(s.capacity() > empty.capacity()) res += s.capacity() + 1;
+    }
+    return res;
+}
+
+size_t bytes(std::vector<fsc::intern_table::id_type> const &v,
+             fsc::intern_table const &table) {
+    size_t res = v.capacity() * sizeof(fsc::intern_table::id_type);
+    // per entry: the string, a hash node (next, hash, id) and a bucket
+    res += table.size() * (sizeof(std::string) + 4 * sizeof(void *));
+
+    auto distinct = v;
+    std::sort(distinct.begin(), distinct.end());
+    distinct.erase(std::unique(distinct.begin(), distinct.end()),
+                   distinct.end());
+    std::string const empty;
+    for(auto id : distinct) {
+        auto const &s = table.str(id);
+        if(s.capacity() > empty.capacity()) res += s.capacity() + 1;
+    }
+    return res;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+// n tokens drawn from a vocabulary of the given size
+std::string make_text(size_t n, size_t vocabulary) {
+    std::string text;
+    for(size_t i = 0; i < n; ++i) {
+        auto const word = static_cast<size_t>(rand()) % vocabulary;
+        text += "token_of_some_length_" + std::to_string(word);
+        text += ' ';
+    }
+    return text;
+}
+
+// splits text at token boundaries into n parts of about the same size
+std::vector<std::string> make_parts(std::string const &text, size_t n) {
+    std::vector<std::string> parts;
+    size_t start = 0;
+    for(size_t i = 1; i <= n; ++i) {
+        auto end = std::min(text.find(' ', i * text.size() / n), text.size());
+        if(end < start) end = start;
+        parts.push_back(text.substr(start, end - start));
+        start = end;
+    }
+    return parts;
+}
+
+void run(std::string const &name, std::string const &text) {
+    auto const n_threads = std::max(2u, std::thread::hardware_concurrency());
+    auto const parts = make_parts(text, n_threads);
+    std::vector<std::string> v;
+    std::vector<fsc::intern_table::id_type> ids;
+    // fresh tables for every pass, created and destroyed outside the timing
+    std::unique_ptr<fsc::intern_table> table;
+    std::unique_ptr<fsc::intern_table> shared;
+
+    MIB_START(main)
+    for(uint i = 0; i < 10; ++i) {
+        table.reset(new fsc::intern_table);
+        shared.reset(new fsc::intern_table);
+
+        MIB_START(split)
+        v = fsc::split(text);
+        MIB_NEXT(split, intern)
+        ids = fsc::split(text, *table);
+        MIB_NEXT(intern, intern_par)
+        // the workers split one part each into the shared, empty table
+        std::vector<std::thread> workers;
+        for(auto const &part : parts) {
+            workers.emplace_back([&part, &shared]() {
+                fsc::split(part, *shared);
+            });
+        }
+        for(auto &w : workers) w.join();
+        MIB_STOP(intern_par)
+    }
+    MIB_STOP(main)
+
+    std::cout << name << ": " << v.size() << " tokens, " << table->size()
+              << " distinct, " << n_threads << " threads" << std::endl;
+    std::cout << "    std::string: " << bytes(v) << " bytes" << std::endl;
+    std::cout << "    interned:    " << bytes(ids, *table) << " bytes"
+              << std::endl;
+    MIB_PRINT(cycle);
+}
+
+// ./internspeed          1e6 tokens from a vocabulary of 50
+// ./internspeed unique   1e6 (almost) unique tokens
+int main(int argc, char *argv[]) {
+    size_t const n = 1e6;
+
+    if(argc > 1 and std::string(argv[1]) == "unique") {
+        run("unique tokens", make_text(n, 1e9));
+    } else {
+        run("high repetition", make_text(n, 50));
+    }
+
+    return 0;
+}